@@ -1,15 +1,487 @@
 #include "LinkedList.h"
 #include <iostream>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <unistd.h>
 
 using namespace std;
 
+static_assert(LINKEDLIST_INLINE_NODES >= 1, "LINKEDLIST_INLINE_NODES must be at least 1");
+
+namespace {
+
+const size_t IO_CHUNK_SIZE = 1 << 16;
+const size_t MAX_FORMATTED_INT = 16; // "-2147483648" plus a separator, rounded up
+
+bool isSeparator(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Pulls chunks through readChunk(buffer, capacity), which returns the number of
+// bytes read, 0 at end of input or -1 on error, and passes every parsed int to
+// append. A token cut off at the end of a chunk is carried over to the front of
+// the buffer and completed by the next read.
+template <typename ReadChunk, typename Append>
+bool parseInts(ReadChunk readChunk, Append append) {
+    vector<char> buffer(IO_CHUNK_SIZE);
+    char* begin = buffer.data();
+    size_t carry = 0;
+
+    while (true) {
+        long bytes = readChunk(begin + carry, buffer.size() - carry);
+        if (bytes < 0)
+            return false;
+
+        bool eof = bytes == 0;
+        char* end = begin + carry + bytes;
+
+        // Only parse up to the last separator unless there is nothing more to read
+        char* limit = end;
+        if (!eof) {
+            while (limit > begin && !isSeparator(limit[-1]))
+                --limit;
+            if (limit == begin) {
+                if (end == begin + buffer.size())
+                    return false; // Token longer than a whole chunk
+                carry = end - begin;
+                continue;
+            }
+        }
+
+        const char* current = begin;
+        while (true) {
+            while (current < limit && isSeparator(*current))
+                ++current;
+            if (current == limit)
+                break;
+
+            int value;
+            from_chars_result result = from_chars(current, limit, value);
+            if (result.ec != errc() || (result.ptr != limit && !isSeparator(*result.ptr)))
+                return false;
+            append(value);
+            current = result.ptr;
+        }
+
+        if (eof)
+            return true;
+
+        carry = end - limit;
+        memmove(begin, limit, carry);
+    }
+}
+
+// Formats the values from node onwards as "a b c \n" into a large buffer and
+// hands it to writeChunk(buffer, size) whenever it fills up.
+template <typename WriteChunk>
+bool formatInts(Node* node, WriteChunk writeChunk) {
+    vector<char> buffer(IO_CHUNK_SIZE);
+    char* begin = buffer.data();
+    char* end = begin + buffer.size();
+    char* out = begin;
+
+    while (node != nullptr) {
+        if (static_cast<size_t>(end - out) < MAX_FORMATTED_INT) {
+            if (!writeChunk(begin, out - begin))
+                return false;
+            out = begin;
+        }
+        out = to_chars(out, end, node->data).ptr;
+        *out++ = ' ';
+        node = node->next;
+    }
+    *out++ = '\n';
+
+    return writeChunk(begin, out - begin);
+}
+
+long readFd(int fd, char* buffer, size_t size) {
+    ssize_t bytes;
+    do {
+        bytes = ::read(fd, buffer, size);
+    } while (bytes < 0 && errno == EINTR);
+    return bytes;
+}
+
+bool writeFd(int fd, const char* buffer, size_t size) {
+    while (size > 0) {
+        ssize_t bytes = ::write(fd, buffer, size);
+        if (bytes < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        buffer += bytes;
+        size -= bytes;
+    }
+    return true;
+}
+
+// Heap nodes come from blocks of this many nodes, doubling up to the maximum
+const size_t MIN_NODE_BLOCK = 64;
+const size_t MAX_NODE_BLOCK = 1 << 16;
+
+// Below this k a bounded heap over the list beats copying every value out
+const int HEAP_SELECT_LIMIT = 64;
+
+// Returns the k values of the list that come first under before, arranged as
+// a heap whose front is the k-th of them. Holds fewer than k values when the
+// list is shorter than k. The list itself is left untouched.
+template <typename Compare>
+vector<int> selectBest(Node* head, int k, Compare before) {
+    vector<int> best;
+    if (k <= 0)
+        return best;
+
+    if (k <= HEAP_SELECT_LIMIT) {
+        best.reserve(k);
+        for (Node* current = head; current != nullptr; current = current->next) {
+            if (best.size() < static_cast<size_t>(k)) {
+                best.push_back(current->data);
+                push_heap(best.begin(), best.end(), before);
+            } else if (before(current->data, best.front())) {
+                pop_heap(best.begin(), best.end(), before);
+                best.back() = current->data;
+                push_heap(best.begin(), best.end(), before);
+            }
+        }
+        return best;
+    }
+
+    for (Node* current = head; current != nullptr; current = current->next)
+        best.push_back(current->data);
+    if (best.size() > static_cast<size_t>(k)) {
+        nth_element(best.begin(), best.begin() + (k - 1), best.end(), before);
+        best.resize(k);
+    }
+    make_heap(best.begin(), best.end(), before);
+    return best;
+}
+
+// Lists shorter than this per thread are not worth splitting further
+const size_t MIN_SEGMENT_LENGTH = 1 << 14;
+
+// Fixed set of worker threads shared by every list. run() hands out task
+// numbers 0..tasks-1 to the workers and the calling thread and returns once
+// all of them have finished. If tasks throw, every task still runs and the
+// first exception is rethrown from run().
+class SegmentPool {
+public:
+    static SegmentPool& instance() {
+        static SegmentPool pool;
+        return pool;
+    }
+
+    size_t threads() const {
+        return workers.size() + 1;
+    }
+
+    void run(size_t tasks, const function<void(size_t)>& task) {
+        // A callback that starts another parallel operation, on a worker or
+        // on the calling thread, runs its tasks inline instead of waiting on
+        // the pool it is already part of
+        if (insidePool) {
+            for (size_t i = 0; i < tasks; ++i)
+                task(i);
+            return;
+        }
+
+        lock_guard<mutex> serial(runLock);
+        Job job(&task, tasks);
+        {
+            lock_guard<mutex> guard(lock);
+            current = &job;
+            generation++;
+        }
+        wake.notify_all();
+
+        insidePool = true;
+        work(job);
+        insidePool = false;
+
+        {
+            unique_lock<mutex> guard(lock);
+            done.wait(guard, [this, &job] { return job.pending == 0 && attached == 0; });
+            current = nullptr;
+        }
+        if (job.error)
+            rethrow_exception(job.error);
+    }
+
+private:
+    struct Job {
+        const function<void(size_t)>* task;
+        size_t tasks;
+        atomic<size_t> next;
+        atomic<size_t> pending;
+        exception_ptr error;
+        Job(const function<void(size_t)>* task, size_t tasks) : task(task), tasks(tasks), next(0), pending(tasks) {}
+    };
+
+    static thread_local bool insidePool;
+
+    vector<thread> workers;
+    mutex runLock;
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    Job* current;
+    size_t generation;
+    size_t attached;
+    bool stopping;
+
+    SegmentPool() : current(nullptr), generation(0), attached(0), stopping(false) {
+        unsigned int cores = thread::hardware_concurrency();
+        for (unsigned int i = 1; i < cores; ++i)
+            workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ~SegmentPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& worker : workers)
+            worker.join();
+    }
+
+    void work(Job& job) {
+        size_t task;
+        while ((task = job.next.fetch_add(1)) < job.tasks) {
+            // Keep the first exception for run() to rethrow once every thread
+            // has let go of the job
+            try {
+                (*job.task)(task);
+            } catch (...) {
+                lock_guard<mutex> guard(lock);
+                if (!job.error)
+                    job.error = current_exception();
+            }
+            if (job.pending.fetch_sub(1) == 1) {
+                lock_guard<mutex> guard(lock);
+                done.notify_all();
+            }
+        }
+    }
+
+    void workerLoop() {
+        insidePool = true;
+        size_t seen = 0;
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [this, &seen] { return stopping || (current != nullptr && generation != seen); });
+            if (stopping)
+                return;
+
+            // Stay attached so run() cannot return while this thread holds the job
+            seen = generation;
+            Job* job = current;
+            attached++;
+            guard.unlock();
+            work(*job);
+            guard.lock();
+            if (--attached == 0)
+                done.notify_all();
+        }
+    }
+};
+
+thread_local bool SegmentPool::insidePool = false;
+
+// Keys for NodeIndex tables: values by their bits, nodes by their address
+unsigned long long valueKey(int value) {
+    return static_cast<unsigned int>(value);
+}
+
+unsigned long long nodeKey(Node* node) {
+    return reinterpret_cast<uintptr_t>(node);
+}
+
+} // namespace
+
 Node::Node(int value) {
     data = value;
     next = nullptr;
 }
 
+NodeIndex::Table::Table() {
+    count = 0;
+    shift = 64;
+}
+
+void NodeIndex::Table::clear() {
+    slots.clear();
+    count = 0;
+    shift = 64;
+}
+
+size_t NodeIndex::Table::home(unsigned long long key) {
+    // Fibonacci hashing spreads consecutive values and aligned addresses alike
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+void NodeIndex::Table::grow() {
+    vector<Slot> old;
+    old.swap(slots);
+    size_t capacity = old.empty() ? 16 : old.size() * 2;
+    slots.assign(capacity, Slot{0, -1});
+    shift = 64;
+    while ((size_t(1) << (64 - shift)) < capacity)
+        shift--;
+
+    count = 0;
+    for (const Slot& slot : old) {
+        if (slot.entry >= 0)
+            insert(slot.key, slot.entry);
+    }
+}
+
+size_t NodeIndex::Table::position(unsigned long long key) {
+    // Returns the slot holding key, or slots.size() if it is absent
+    if (count == 0)
+        return slots.size();
+
+    size_t mask = slots.size() - 1;
+    for (size_t slot = home(key); slots[slot].entry >= 0; slot = (slot + 1) & mask) {
+        if (slots[slot].key == key)
+            return slot;
+    }
+    return slots.size();
+}
+
+int* NodeIndex::Table::find(unsigned long long key) {
+    size_t slot = position(key);
+    return slot == slots.size() ? nullptr : &slots[slot].entry;
+}
+
+void NodeIndex::Table::insert(unsigned long long key, int entry) {
+    // Keep the load factor at or below one half
+    if ((count + 1) * 2 > slots.size())
+        grow();
+
+    size_t mask = slots.size() - 1;
+    size_t slot = home(key);
+    while (slots[slot].entry >= 0)
+        slot = (slot + 1) & mask;
+    slots[slot] = Slot{key, entry};
+    count++;
+}
+
+void NodeIndex::Table::erase(unsigned long long key) {
+    size_t hole = position(key);
+    if (hole == slots.size())
+        return;
+
+    // Backward-shift deletion keeps probe sequences intact without tombstones
+    size_t mask = slots.size() - 1;
+    size_t next = (hole + 1) & mask;
+    while (slots[next].entry >= 0) {
+        size_t ideal = home(slots[next].key);
+        if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    slots[hole].entry = -1;
+    count--;
+}
+
+NodeIndex::NodeIndex() {
+    freeEntry = -1;
+}
+
+void NodeIndex::clear() {
+    entries.clear();
+    freeEntry = -1;
+    firstByValue.clear();
+    entryByNode.clear();
+}
+
+void NodeIndex::insert(Node* node, Node* prev) {
+    int id;
+    if (freeEntry >= 0) {
+        id = freeEntry;
+        freeEntry = entries[id].nextSame;
+    } else {
+        id = static_cast<int>(entries.size());
+        entries.push_back(Entry());
+    }
+    entries[id] = Entry{node, prev, id, id};
+
+    // Nodes are inserted in list order, so a new one goes last among its value
+    int* first = firstByValue.find(valueKey(node->data));
+    if (first == nullptr) {
+        firstByValue.insert(valueKey(node->data), id);
+    } else {
+        int last = entries[*first].prevSame;
+        entries[id].prevSame = last;
+        entries[id].nextSame = *first;
+        entries[last].nextSame = id;
+        entries[*first].prevSame = id;
+    }
+    entryByNode.insert(nodeKey(node), id);
+}
+
+NodeIndex::Entry* NodeIndex::find(Node* node) {
+    int* id = entryByNode.find(nodeKey(node));
+    return id == nullptr ? nullptr : &entries[*id];
+}
+
+NodeIndex::Entry* NodeIndex::first(int value) {
+    int* id = firstByValue.find(valueKey(value));
+    return id == nullptr ? nullptr : &entries[*id];
+}
+
+void NodeIndex::erase(Entry* entry) {
+    int id = static_cast<int>(entry - entries.data());
+    unsigned long long key = valueKey(entry->node->data);
+    entryByNode.erase(nodeKey(entry->node));
+
+    if (entry->nextSame == id) {
+        firstByValue.erase(key);
+    } else {
+        entries[entry->prevSame].nextSame = entry->nextSame;
+        entries[entry->nextSame].prevSame = entry->prevSame;
+        int* first = firstByValue.find(key);
+        if (*first == id)
+            *first = entry->nextSame;
+    }
+
+    entry->node = nullptr;
+    entry->nextSame = freeEntry;
+    freeEntry = id;
+}
+
 LinkedList::LinkedList() {
     head = nullptr;
+    tail = nullptr;
+    trackAggregates = false;
+    aggregateSum = 0;
+    inlineUsed = 0;
+    inlineFree = nullptr;
+    blockUsed = 0;
+    blockCapacity = 0;
+    blockFree = nullptr;
+    useIndex = false;
+    indexStale = false;
+    splitStride = 0;
+    lastSegmentLength = 0;
+    maxSplits = 0;
+    splitsStale = true;
 }
 
 LinkedList::~LinkedList() {
@@ -21,11 +493,14 @@ Node* LinkedList::getHead() {
 }
 
 Node* LinkedList::getTail() {
-    Node* temp = head;
-    while (temp != nullptr && temp->next != nullptr) {
-        temp = temp->next;
+    return tail;
+}
+
+void LinkedList::refreshTail() {
+    tail = head;
+    while (tail != nullptr && tail->next != nullptr) {
+        tail = tail->next;
     }
-    return temp;
 }
 
 int LinkedList::length() {
@@ -51,27 +526,151 @@ int LinkedList::getNthNodeIndex(Node* nthnode) {
     return -1;
 }
 
-void LinkedList::addNode(int value) {
-    Node* newNode = new Node(value);
-    if (head == nullptr) {
+Node* LinkedList::acquireNode(int value) {
+    // Reuse a released inline slot first, then a fresh one, then the blocks
+    Node* node = nullptr;
+    if (inlineFree != nullptr) {
+        node = inlineFree;
+        inlineFree = node->next;
+    } else if (inlineUsed < LINKEDLIST_INLINE_NODES) {
+        unsigned char* slot = inlineStorage + inlineUsed * sizeof(Node);
+        inlineUsed++;
+        return new (slot) Node(value);
+    } else if (blockFree != nullptr) {
+        node = blockFree;
+        blockFree = node->next;
+    }
+    if (node != nullptr) {
+        node->data = value;
+        node->next = nullptr;
+        return node;
+    }
+
+    if (blockUsed == blockCapacity) {
+        // Blocks double in size so bulk ingest costs one allocation per block
+        blockCapacity = min(max<size_t>(2 * blockCapacity, MIN_NODE_BLOCK), MAX_NODE_BLOCK);
+        nodeBlocks.emplace_back(new unsigned char[blockCapacity * sizeof(Node)]);
+        blockUsed = 0;
+    }
+    unsigned char* slot = nodeBlocks.back().get() + blockUsed * sizeof(Node);
+    blockUsed++;
+    return new (slot) Node(value);
+}
+
+void LinkedList::releaseNode(Node* node) {
+    // Block nodes are only recycled; their memory is kept until deleteLinkedList
+    if (isInline(node)) {
+        node->next = inlineFree;
+        inlineFree = node;
+    } else {
+        node->next = blockFree;
+        blockFree = node;
+    }
+}
+
+bool LinkedList::isInline(Node* node) {
+    // std::less gives a total order even for pointers into unrelated objects
+    const unsigned char* address = reinterpret_cast<const unsigned char*>(node);
+    less<const unsigned char*> before;
+    return !before(address, inlineStorage) && before(address, inlineStorage + sizeof(inlineStorage));
+}
+
+void LinkedList::trackInsert(int value) {
+    if (!trackAggregates)
+        return;
+    aggregateSum += value;
+    valueCounts[value]++;
+}
+
+void LinkedList::trackErase(int value) {
+    if (!trackAggregates)
+        return;
+    aggregateSum -= value;
+    map<int, int>::iterator entry = valueCounts.find(value);
+    if (entry != valueCounts.end() && --entry->second == 0)
+        valueCounts.erase(entry);
+}
+
+void LinkedList::structureChanged() {
+    indexStale = true;
+    splitsStale = true;
+}
+
+void LinkedList::ensureIndex() {
+    if (!useIndex || !indexStale)
+        return;
+
+    valueIndex.clear();
+    Node* prev = nullptr;
+    for (Node* current = head; current != nullptr; current = current->next) {
+        valueIndex.insert(current, prev);
+        prev = current;
+    }
+    indexStale = false;
+}
+
+void LinkedList::appendNode(int value) {
+    Node* newNode = acquireNode(value);
+    trackInsert(value);
+    splitAppended(newNode);
+    if (useIndex && !indexStale)
+        valueIndex.insert(newNode, tail);
+    if (tail == nullptr) {
         head = newNode;
     } else {
-        Node* temp = head;
-        while (temp->next != nullptr) {
-            temp = temp->next;
-        }
-        temp->next = newNode;
+        tail->next = newNode;
     }
+    tail = newNode;
+}
+
+void LinkedList::addNode(int value) {
+    appendNode(value);
 }
 
 void LinkedList::deleteNode(int value, Node* head) {
     if (head == nullptr)
         return;
 
+    if (useIndex && head == this->head) {
+        ensureIndex();
+        NodeIndex::Entry* entry = valueIndex.first(value);
+        if (entry == nullptr)
+            return;
+
+        // The successor inherits the removed node's predecessor
+        Node* toDelete = entry->node;
+        Node* prev = entry->prev;
+        if (toDelete->next != nullptr)
+            valueIndex.find(toDelete->next)->prev = prev;
+        valueIndex.erase(entry);
+        splitRemoved(toDelete);
+
+        if (prev == nullptr)
+            this->head = toDelete->next;
+        else
+            prev->next = toDelete->next;
+        if (toDelete == tail)
+            tail = prev;
+        trackErase(value);
+        releaseNode(toDelete);
+        return;
+    }
+
+    // Deleting relative to an arbitrary node bypasses the index, and one that
+    // is not our head may not even unlink the node from our list
+    indexStale = true;
+    if (head != this->head)
+        splitsStale = true;
+
     if (head->data == value) {
-        Node* temp = head;
-        head = head->next;
-        delete temp;
+        // Keep the list's own head valid when its first node is removed
+        if (head == this->head)
+            this->head = head->next;
+        if (head == tail)
+            tail = nullptr;
+        trackErase(value);
+        splitRemoved(head);
+        releaseNode(head);
         return;
     }
 
@@ -83,7 +682,11 @@ void LinkedList::deleteNode(int value, Node* head) {
     if (temp->next != nullptr) {
         Node* toDelete = temp->next;
         temp->next = temp->next->next;
-        delete toDelete;
+        if (toDelete == tail)
+            tail = temp;
+        trackErase(value);
+        splitRemoved(toDelete);
+        releaseNode(toDelete);
     }
 }
 
@@ -97,7 +700,9 @@ void LinkedList::reverseLinkedList() {
         prev = current;
         current = next;
     }
+    tail = head;
     head = prev;
+    structureChanged();
 }
 
 Node* LinkedList::findMiddleNode(Node* head) {
@@ -114,40 +719,73 @@ Node* LinkedList::findMiddleNode(Node* head) {
 }
 
 void LinkedList::deleteLinkedList() {
-    Node* current = head;
-    Node* next;
-    while (current != nullptr) {
-        next = current->next;
-        delete current;
-        current = next;
-    }
+    // Node is trivially destructible, so dropping the blocks frees every node
     head = nullptr;
+    tail = nullptr;
+    inlineUsed = 0;
+    inlineFree = nullptr;
+    nodeBlocks.clear();
+    blockUsed = 0;
+    blockCapacity = 0;
+    blockFree = nullptr;
+    valueIndex.clear();
+    indexStale = false;
+    splitsStale = true;
+    aggregateSum = 0;
+    valueCounts.clear();
 }
 
 void LinkedList::printLinkedList() {
-    Node* temp = head;
-    while (temp != nullptr) {
-        cout << temp->data << " ";
-        temp = temp->next;
-    }
-    cout << endl;
+    writeTo(cout);
+    cout.flush();
+}
+
+bool LinkedList::readFrom(istream& in) {
+    istream::sentry sentry(in, true);
+    if (!sentry)
+        return false;
+
+    streambuf* source = in.rdbuf();
+    bool parsed = parseInts(
+        [source](char* buffer, size_t size) { return static_cast<long>(source->sgetn(buffer, size)); },
+        [this](int value) { appendNode(value); });
+    in.setstate(parsed ? ios::eofbit : ios::failbit);
+    return parsed;
+}
+
+bool LinkedList::readFrom(int fd) {
+    return parseInts(
+        [fd](char* buffer, size_t size) { return readFd(fd, buffer, size); },
+        [this](int value) { appendNode(value); });
+}
+
+bool LinkedList::writeTo(ostream& out) {
+    return formatInts(head, [&out](const char* buffer, size_t size) {
+        out.write(buffer, size);
+        return static_cast<bool>(out);
+    });
+}
+
+bool LinkedList::writeTo(int fd) {
+    return formatInts(head, [fd](const char* buffer, size_t size) { return writeFd(fd, buffer, size); });
 }
 
 Node* LinkedList::merge(Node* left, Node* right) {
-    Node* result = nullptr;
-    if (left == nullptr)
-        return right;
-    if (right == nullptr)
-        return left;
-
-    if (left->data <= right->data) {
-        result = left;
-        result->next = merge(left->next, right);
-    } else {
-        result = right;
-        result->next = merge(left, right->next);
+    // Iterative so that merging long lists cannot overflow the stack
+    Node sentinel(0);
+    Node* last = &sentinel;
+    while (left != nullptr && right != nullptr) {
+        if (left->data <= right->data) {
+            last->next = left;
+            left = left->next;
+        } else {
+            last->next = right;
+            right = right->next;
+        }
+        last = last->next;
     }
-    return result;
+    last->next = left != nullptr ? left : right;
+    return sentinel.next;
 }
 
 Node* LinkedList::mergeSort(Node* head) {
@@ -167,16 +805,28 @@ Node* LinkedList::mergeSort(Node* head) {
 
 void LinkedList::sortLinkedList() {
     head = mergeSort(head);
+    refreshTail();
+    structureChanged();
 }
 
 bool LinkedList::binarySearch(int key) {
+    return findNode(key) != nullptr;
+}
+
+Node* LinkedList::findNode(int value) {
+    if (useIndex) {
+        ensureIndex();
+        NodeIndex::Entry* entry = valueIndex.first(value);
+        return entry == nullptr ? nullptr : entry->node;
+    }
+
     Node* current = head;
     while (current != nullptr) {
-        if (current->data == key)
-            return true;
+        if (current->data == value)
+            return current;
         current = current->next;
     }
-    return false;
+    return nullptr;
 }
 
 Node* LinkedList::getNthNode(int index) {
@@ -194,6 +844,53 @@ Node* LinkedList::getNthNode(int index) {
     return nullptr; // Index out of bounds
 }
 
+vector<bool> LinkedList::containsBatch(const vector<int>& keys) {
+    if (useIndex) {
+        ensureIndex();
+        vector<bool> results(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i)
+            results[i] = valueIndex.first(keys[i]) != nullptr;
+        return results;
+    }
+
+    // Every key still in the set after the traversal was not found
+    unordered_set<int> pending(keys.begin(), keys.end());
+    Node* current = head;
+    while (current != nullptr && !pending.empty()) {
+        pending.erase(current->data);
+        current = current->next;
+    }
+
+    vector<bool> results(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+        results[i] = pending.find(keys[i]) == pending.end();
+    return results;
+}
+
+vector<Node*> LinkedList::nthBatch(const vector<int>& indices) {
+    // Visit the queries in increasing index order so one walk answers all of them
+    vector<size_t> order(indices.size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&indices](size_t a, size_t b) { return indices[a] < indices[b]; });
+
+    vector<Node*> results(indices.size(), nullptr);
+    Node* current = head;
+    int count = 0;
+    for (size_t query : order) {
+        int index = indices[query];
+        if (index < 0)
+            continue;
+        while (current != nullptr && count < index) {
+            current = current->next;
+            count++;
+        }
+        if (current == nullptr)
+            break; // This and every later index is out of bounds
+        results[query] = current;
+    }
+    return results;
+}
+
 void LinkedList::rotate(int k) {
     if (head == nullptr || k <= 0)
         return;
@@ -222,6 +919,66 @@ void LinkedList::rotate(int k) {
     // Update head and break the circular structure
     head = current->next;
     current->next = nullptr;
+    tail = current;
+    structureChanged();
+}
+
+Node* LinkedList::rotateRight(Node* head, int k) {
+    if (head == this->head) {
+        rotate(k);
+        return this->head;
+    }
+
+    if (head == nullptr || k <= 0)
+        return head;
+
+    int size = 1;
+    Node* last = head;
+    while (last->next != nullptr) {
+        last = last->next;
+        size++;
+    }
+
+    k %= size;
+    if (k == 0)
+        return head;
+
+    // The node size - k places in becomes the new end of the chain
+    Node* newLast = head;
+    for (int i = 1; i < size - k; ++i) {
+        newLast = newLast->next;
+    }
+    Node* newHead = newLast->next;
+    newLast->next = nullptr;
+    last->next = head;
+
+    refreshTail();
+    structureChanged();
+    return newHead;
+}
+
+Node* LinkedList::mergeSortedLists(Node* list1, Node* list2) {
+    Node* merged = merge(list1, list2);
+
+    // Merging one of our own chains into the list head updates the list
+    if (head != nullptr && (list1 == head || list2 == head)) {
+        head = merged;
+        refreshTail();
+        structureChanged();
+    }
+    return merged;
+}
+
+bool LinkedList::hasLoop() {
+    Node* slow = head;
+    Node* fast = head;
+    while (fast != nullptr && fast->next != nullptr) {
+        slow = slow->next;
+        fast = fast->next->next;
+        if (slow == fast)
+            return true;
+    }
+    return false;
 }
 
 void LinkedList::removeDuplicates() {
@@ -236,7 +993,8 @@ void LinkedList::removeDuplicates() {
         // If the value is already in the set, remove the current node
         if (seen_values.find(current->data) != seen_values.end()) {
             prev->next = current->next;
-            delete current;
+            trackErase(current->data);
+            releaseNode(current);
             current = prev->next; // Move to the next node
         } else {
             // Add the value to the set if it's not already there
@@ -245,33 +1003,60 @@ void LinkedList::removeDuplicates() {
             current = current->next;
         }
     }
+    tail = prev;
+    structureChanged();
 }
 
-Node* LinkedList::swapPairs(Node* head) {
-    if (head == nullptr || head->next == nullptr)
-        return head; // No need to swap if the list has zero or one node
-
-    Node* dummy = new Node(0); // Dummy node to handle edge cases
-    dummy->next = head;
-    Node* prev = dummy;
+Node* LinkedList::reverseGroups(Node* first, int k) {
+    Node sentinel(0); // Stack sentinel so the first group needs no special case
+    sentinel.next = first;
+    Node* prev = &sentinel;
 
-    while (prev->next != nullptr && prev->next->next != nullptr) {
-        Node* first = prev->next;
-        Node* second = prev->next->next;
-
-        // Swapping nodes
-        first->next = second->next;
-        second->next = first;
-        prev->next = second;
+    while (true) {
+        // Stop when fewer than k nodes are left; they keep their order
+        Node* after = prev->next;
+        int count = 0;
+        while (after != nullptr && count < k) {
+            after = after->next;
+            count++;
+        }
+        if (count < k)
+            break;
 
-        // Move to the next pair of nodes
-        prev = first;
+        // Reverse the group in place and link it between prev and after
+        Node* groupFirst = prev->next;
+        Node* current = groupFirst;
+        Node* reversed = after;
+        for (int i = 0; i < k; ++i) {
+            Node* next = current->next;
+            current->next = reversed;
+            reversed = current;
+            current = next;
+        }
+        prev->next = reversed;
+        prev = groupFirst;
     }
 
-    head = dummy->next;
-    delete dummy;
+    return sentinel.next;
+}
 
-    return head;
+void LinkedList::reverseInGroups(int k) {
+    if (k < 2)
+        return;
+    head = reverseGroups(head, k);
+    refreshTail();
+    structureChanged();
+}
+
+Node* LinkedList::swapPairs(Node* head) {
+    if (head == this->head) {
+        reverseInGroups(2);
+        return this->head;
+    }
+    Node* swapped = reverseGroups(head, 2);
+    refreshTail();
+    structureChanged();
+    return swapped;
 }
 
 int LinkedList::getSecondMax(Node* head) {
@@ -288,4 +1073,220 @@ int LinkedList::getSecondMin(Node* head) {
     if(head == nullptr) return -1;
     if(head->next == nullptr) return head->data;
     return head->next->data;
-}
\ No newline at end of file
+}
+
+int LinkedList::kthLargest(int k) {
+    vector<int> best = selectBest(head, k, greater<int>());
+    if (k <= 0 || best.size() < static_cast<size_t>(k))
+        return -1;
+    return best.front();
+}
+
+int LinkedList::kthSmallest(int k) {
+    vector<int> best = selectBest(head, k, less<int>());
+    if (k <= 0 || best.size() < static_cast<size_t>(k))
+        return -1;
+    return best.front();
+}
+
+vector<int> LinkedList::topK(int k) {
+    vector<int> best = selectBest(head, k, greater<int>());
+    sort_heap(best.begin(), best.end(), greater<int>());
+    return best;
+}
+
+void LinkedList::enableAggregates() {
+    if (trackAggregates)
+        return;
+
+    trackAggregates = true;
+    for (Node* current = head; current != nullptr; current = current->next)
+        trackInsert(current->data);
+}
+
+void LinkedList::disableAggregates() {
+    trackAggregates = false;
+    aggregateSum = 0;
+    valueCounts.clear();
+}
+
+int LinkedList::minValue() {
+    if (!trackAggregates)
+        return kthSmallest(1);
+    if (valueCounts.empty())
+        return -1;
+    return valueCounts.begin()->first;
+}
+
+int LinkedList::maxValue() {
+    if (!trackAggregates)
+        return kthLargest(1);
+    if (valueCounts.empty())
+        return -1;
+    return valueCounts.rbegin()->first;
+}
+
+int LinkedList::secondMinValue() {
+    if (!trackAggregates)
+        return kthSmallest(2);
+    if (valueCounts.empty())
+        return -1;
+
+    // A repeated minimum is also the second smallest value
+    map<int, int>::iterator smallest = valueCounts.begin();
+    if (smallest->second > 1)
+        return smallest->first;
+    ++smallest;
+    return smallest == valueCounts.end() ? -1 : smallest->first;
+}
+
+int LinkedList::secondMaxValue() {
+    if (!trackAggregates)
+        return kthLargest(2);
+    if (valueCounts.empty())
+        return -1;
+
+    // A repeated maximum is also the second largest value
+    map<int, int>::reverse_iterator largest = valueCounts.rbegin();
+    if (largest->second > 1)
+        return largest->first;
+    ++largest;
+    return largest == valueCounts.rend() ? -1 : largest->first;
+}
+
+long long LinkedList::sum() {
+    if (trackAggregates)
+        return aggregateSum;
+
+    long long total = 0;
+    for (Node* current = head; current != nullptr; current = current->next)
+        total += current->data;
+    return total;
+}
+
+int LinkedList::countOf(int value) {
+    if (trackAggregates) {
+        map<int, int>::iterator entry = valueCounts.find(value);
+        return entry == valueCounts.end() ? 0 : entry->second;
+    }
+
+    int count = 0;
+    for (Node* current = head; current != nullptr; current = current->next) {
+        if (current->data == value)
+            count++;
+    }
+    return count;
+}
+
+void LinkedList::enableIndex() {
+    if (useIndex)
+        return;
+
+    // Built on first use rather than here
+    useIndex = true;
+    indexStale = true;
+}
+
+void LinkedList::disableIndex() {
+    useIndex = false;
+    valueIndex.clear();
+}
+
+void LinkedList::ensureSplits() {
+    // splitAppended and splitRemoved keep the split points current, so the
+    // list is only walked again after relinking or once it has doubled
+    if (!splitsStale)
+        return;
+
+    size_t size = 0;
+    for (Node* current = head; current != nullptr; current = current->next)
+        size++;
+
+    splitPoints.clear();
+    if (size == 0)
+        return;
+
+    size_t threads = SegmentPool::instance().threads();
+    size_t segments = min(threads, max<size_t>(size / MIN_SEGMENT_LENGTH, 1));
+    Node* current = head;
+    for (size_t segment = 0; segment < segments; ++segment) {
+        splitPoints.push_back(current);
+        size_t segmentLength = size / segments + (segment < size % segments ? 1 : 0);
+        for (size_t i = 0; i < segmentLength; ++i)
+            current = current->next;
+    }
+
+    splitStride = max(size / segments, MIN_SEGMENT_LENGTH);
+    lastSegmentLength = size / segments;
+    maxSplits = 2 * threads;
+    splitsStale = false;
+}
+
+void LinkedList::splitAppended(Node* node) {
+    if (splitsStale)
+        return;
+
+    // Start a new segment at the tail rather than growing the last one, and
+    // rebalance from scratch once there are twice as many segments as threads
+    if (lastSegmentLength >= splitStride) {
+        if (splitPoints.size() >= maxSplits) {
+            splitsStale = true;
+            return;
+        }
+        splitPoints.push_back(node);
+        lastSegmentLength = 0;
+    }
+    lastSegmentLength++;
+}
+
+void LinkedList::splitRemoved(Node* node) {
+    if (splitsStale)
+        return;
+
+    // Only a removed segment start needs fixing: its successor takes over,
+    // unless that would leave the segment empty
+    for (size_t segment = 0; segment < splitPoints.size(); ++segment) {
+        if (splitPoints[segment] != node)
+            continue;
+
+        bool last = segment + 1 == splitPoints.size();
+        Node* next = node->next;
+        if (next != nullptr && (last || splitPoints[segment + 1] != next)) {
+            splitPoints[segment] = next;
+            if (last)
+                lastSegmentLength--;
+        } else {
+            splitsStale = true;
+        }
+        return;
+    }
+}
+
+size_t LinkedList::segmentCount() {
+    ensureSplits();
+    return splitPoints.size();
+}
+
+void LinkedList::runSegments(const function<void(size_t, Node*, Node*)>& work) {
+    ensureSplits();
+    if (head == nullptr)
+        return;
+
+    if (splitPoints.size() == 1) {
+        work(0, head, nullptr);
+        return;
+    }
+
+    SegmentPool::instance().run(splitPoints.size(), [this, &work](size_t segment) {
+        Node* end = segment + 1 < splitPoints.size() ? splitPoints[segment + 1] : nullptr;
+        work(segment, splitPoints[segment], end);
+    });
+}
+
+void LinkedList::valuesChanged() {
+    indexStale = true;
+    if (trackAggregates) {
+        disableAggregates();
+        enableAggregates();
+    }
+}
@@ -1,8 +1,19 @@
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <unordered_set>
+#include <vector>
+
+// Number of nodes each LinkedList stores inside the object itself before
+// falling back to heap allocation. Must be at least 1, and must be the same
+// in every translation unit since it changes the layout of LinkedList.
+#ifndef LINKEDLIST_INLINE_NODES
+#define LINKEDLIST_INLINE_NODES 16
+#endif
 
 class Node {
 public:
@@ -11,12 +22,95 @@ public:
     Node(int value);
 };
 
+// Hash index over the nodes of a LinkedList, used for expected O(1) lookup
+// and unlinking. Each distinct value owns one slot pointing at the first of
+// its entries, which form a circular list in list order, and each node is
+// also found by address, so repeated values never lengthen a probe.
+class NodeIndex {
+public:
+    struct Entry {
+        Node* node;
+        Node* prev;
+        int nextSame;
+        int prevSame;
+    };
+    NodeIndex();
+    void clear();
+    void insert(Node* node, Node* prev);
+    Entry* find(Node* node);
+    Entry* first(int value);
+    void erase(Entry* entry);
+private:
+    // Open-addressing map from a 64-bit key to an entry number
+    class Table {
+    public:
+        Table();
+        void clear();
+        int* find(unsigned long long key);
+        void insert(unsigned long long key, int entry);
+        void erase(unsigned long long key);
+    private:
+        struct Slot {
+            unsigned long long key;
+            int entry;
+        };
+        std::vector<Slot> slots;
+        size_t count;
+        int shift;
+        size_t home(unsigned long long key);
+        size_t position(unsigned long long key);
+        void grow();
+    };
+    std::vector<Entry> entries;
+    int freeEntry;
+    Table firstByValue;
+    Table entryByNode;
+};
+
 class LinkedList {
 private:
     Node* head;
+    Node* tail;
+    bool trackAggregates;
+    long long aggregateSum;
+    std::map<int, int> valueCounts;
+    alignas(Node) unsigned char inlineStorage[LINKEDLIST_INLINE_NODES * sizeof(Node)];
+    int inlineUsed;
+    Node* inlineFree;
+    // Overflow nodes; a block is freed only by deleteLinkedList or the destructor
+    std::vector<std::unique_ptr<unsigned char[]>> nodeBlocks;
+    size_t blockUsed;
+    size_t blockCapacity;
+    Node* blockFree;
+    Node* acquireNode(int value);
+    void releaseNode(Node* node);
+    bool isInline(Node* node);
+    bool useIndex;
+    bool indexStale;
+    NodeIndex valueIndex;
+    void ensureIndex();
+    void structureChanged();
+    void appendNode(int value);
+    void refreshTail();
+    Node* reverseGroups(Node* first, int k);
+    void trackInsert(int value);
+    void trackErase(int value);
+    std::vector<Node*> splitPoints;
+    size_t splitStride;
+    size_t lastSegmentLength;
+    size_t maxSplits;
+    bool splitsStale;
+    void ensureSplits();
+    void splitAppended(Node* node);
+    void splitRemoved(Node* node);
+    size_t segmentCount();
+    void runSegments(const std::function<void(size_t, Node*, Node*)>& work);
+    void valuesChanged();
 public:
     LinkedList();
     ~LinkedList();
+    LinkedList(const LinkedList&) = delete;
+    LinkedList& operator=(const LinkedList&) = delete;
     Node* getHead();
     Node* getTail();
     int length();
@@ -26,20 +120,97 @@ public:
     Node* findMiddleNode(Node* head);
     void deleteLinkedList();
     void printLinkedList();
+    bool readFrom(std::istream& in);
+    bool readFrom(int fd);
+    bool writeTo(std::ostream& out);
+    bool writeTo(int fd);
     Node* merge(Node* left, Node* right);
     Node* mergeSort(Node* head);
     void sortLinkedList();
     bool binarySearch(int key);
+    Node* findNode(int value);
     Node* getNthNode(int index);
+    std::vector<bool> containsBatch(const std::vector<int>& keys);
+    std::vector<Node*> nthBatch(const std::vector<int>& indices);
     void rotate(int k);
     Node* mergeSortedLists(Node* list1, Node* list2);
     bool hasLoop();
     void removeDuplicates();
     Node* swapPairs(Node* head);
+    void reverseInGroups(int k);
     Node* rotateRight(Node* head, int k);
     int getNthNodeIndex(Node* nthnode);
     int getSecondMax(Node* head);
     int getSecondMin(Node* head);
+    int kthLargest(int k);
+    int kthSmallest(int k);
+    std::vector<int> topK(int k);
+    void enableAggregates();
+    void disableAggregates();
+    int minValue();
+    int maxValue();
+    int secondMinValue();
+    int secondMaxValue();
+    long long sum();
+    int countOf(int value);
+    void enableIndex();
+    void disableIndex();
+    template <typename Function>
+    void parallelForEach(Function function);
+    template <typename Function>
+    void parallelTransform(Function function);
+    template <typename T, typename Accumulate, typename Combine>
+    T parallelReduce(T identity, Accumulate accumulate, Combine combine);
 };
 
+// Calls function(value) for every value, with segments of the list visited
+// concurrently. The order of calls across segments is unspecified.
+template <typename Function>
+void LinkedList::parallelForEach(Function function) {
+    runSegments([&function](size_t, Node* begin, Node* end) {
+        for (const Node* current = begin; current != end; current = current->next)
+            function(current->data);
+    });
+}
+
+// Replaces every value with function(value), segments in parallel.
+template <typename Function>
+void LinkedList::parallelTransform(Function function) {
+    // Values already replaced before a callback throws stay replaced
+    try {
+        runSegments([&function](size_t, Node* begin, Node* end) {
+            for (Node* current = begin; current != end; current = current->next)
+                current->data = function(current->data);
+        });
+    } catch (...) {
+        valuesChanged();
+        throw;
+    }
+    valuesChanged();
+}
+
+// Folds each segment with accumulate(partial, value) starting from identity,
+// then folds the per-segment results with combine in list order, so the
+// result does not depend on thread scheduling.
+template <typename T, typename Accumulate, typename Combine>
+T LinkedList::parallelReduce(T identity, Accumulate accumulate, Combine combine) {
+    // Wrapped so T = bool cannot become std::vector<bool>, whose packed
+    // elements share storage and would race as segments store their results
+    struct Partial {
+        T value;
+    };
+    std::vector<Partial> partials(segmentCount(), Partial{identity});
+    runSegments([&](size_t segment, Node* begin, Node* end) {
+        T result = identity;
+        for (const Node* current = begin; current != end; current = current->next)
+            result = accumulate(std::move(result), current->data);
+        partials[segment].value = std::move(result);
+    });
+
+    T result = identity;
+    for (Partial& partial : partials)
+        result = combine(std::move(result), std::move(partial.value));
+    return result;
+}
+
 #endif // LINKEDLIST_H
@@ -0,0 +1,107 @@
+#include "LinkedList.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <unistd.h>
+
+// Measures readFrom/writeTo throughput through a file descriptor on a
+// temporary file, which normally stays in the page cache, and the speedup
+// of parallelReduce over a serial walk.
+
+#define BENCH_LENGTH 10000000
+#define BENCH_REPEATS 5
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int length = argc > 1 ? std::atoi(argv[1]) : BENCH_LENGTH;
+
+    // Fill the source list with values of every width, including negative ones
+    LinkedList source;
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> values;
+    for (int i = 0; i < length; ++i)
+        source.addNode(values(random) >> (i % 31));
+
+    char path[] = "/tmp/LinkedListBenchXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        std::perror("mkstemp");
+        return 1;
+    }
+    unlink(path);
+
+    // Keep the best of a few runs of each direction
+    double writeSeconds = 0;
+    double readSeconds = 0;
+    off_t bytes = 0;
+    for (int run = 0; run < BENCH_REPEATS; ++run) {
+        if (ftruncate(fd, 0) != 0 || lseek(fd, 0, SEEK_SET) != 0) {
+            std::perror("ftruncate");
+            return 1;
+        }
+        auto start = std::chrono::steady_clock::now();
+        if (!source.writeTo(fd)) {
+            std::perror("writeTo");
+            return 1;
+        }
+        double seconds = secondsSince(start);
+        if (run == 0 || seconds < writeSeconds)
+            writeSeconds = seconds;
+        bytes = lseek(fd, 0, SEEK_CUR);
+
+        lseek(fd, 0, SEEK_SET);
+        LinkedList copy;
+        start = std::chrono::steady_clock::now();
+        if (!copy.readFrom(fd)) {
+            std::perror("readFrom");
+            return 1;
+        }
+        seconds = secondsSince(start);
+        if (run == 0 || seconds < readSeconds)
+            readSeconds = seconds;
+    }
+    close(fd);
+
+    // Sum the list serially and with parallelReduce, after a warm-up call
+    // has cached the split points
+    long long parallelSum = source.parallelReduce(0LL,
+        [](long long partial, int value) { return partial + value; },
+        [](long long left, long long right) { return left + right; });
+    double serialSeconds = 0;
+    double parallelSeconds = 0;
+    for (int run = 0; run < BENCH_REPEATS; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        long long serialSum = 0;
+        for (Node* current = source.getHead(); current != nullptr; current = current->next)
+            serialSum += current->data;
+        double seconds = secondsSince(start);
+        if (run == 0 || seconds < serialSeconds)
+            serialSeconds = seconds;
+
+        start = std::chrono::steady_clock::now();
+        parallelSum = source.parallelReduce(0LL,
+            [](long long partial, int value) { return partial + value; },
+            [](long long left, long long right) { return left + right; });
+        seconds = secondsSince(start);
+        if (run == 0 || seconds < parallelSeconds)
+            parallelSeconds = seconds;
+        if (parallelSum != serialSum) {
+            std::cerr << "parallelReduce: wrong sum" << std::endl;
+            return 1;
+        }
+    }
+
+    double megabytes = bytes / 1e6;
+    std::cout << length << " values, " << megabytes << " MB" << std::endl;
+    std::cout << "writeTo:  " << megabytes / writeSeconds << " MB/s" << std::endl;
+    std::cout << "readFrom: " << megabytes / readSeconds << " MB/s" << std::endl;
+    std::cout << "parallelReduce: " << serialSeconds / parallelSeconds << "x a serial walk ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,565 @@
+#include <deepstate/DeepState.hpp>
+#include "LinkedList.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <list>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+using namespace deepstate;
+
+#define MAX_FUZZ_LENGTH 1000000
+#define MAX_FUZZ_OPERATIONS 64
+#define LARGE_FUZZ_LENGTH 65536
+#define MAX_LARGE_FUZZ_OPERATIONS 8
+#define MAX_FUZZ_VALUE 1000
+#define MAX_FUZZ_QUERIES 16
+
+#define COMPLEXITY_MIN_LENGTH (1 << 9)
+#define COMPLEXITY_DOUBLINGS 8
+#define COMPLEXITY_REPEATS 5
+#define COMPLEXITY_MIN_SECONDS 0.03
+#define COMPLEXITY_TOLERANCE 0.12
+#define LOW_CARDINALITY_VALUES 16
+
+// Slopes measured for each operation on a healthy build, typical of several
+// runs on a single-core x86-64 machine; see checkGrowth. Machines with other
+// cache sizes may need them measured again from the logged slopes.
+#define ADD_NODE_SLOPE 0.08
+#define READ_WRITE_SLOPE 0.08
+#define SORT_SLOPE 0.21
+#define REORDERING_SLOPE 0.14
+#define INDEXED_DELETE_SLOPE 0.10
+#define REPEATED_VALUES_SLOPE -0.18
+#define BATCHED_QUERIES_SLOPE 0.14
+#define SELECTION_SLOPE 0.14
+#define TRACKED_AGGREGATES_SLOPE -0.30
+#define PARALLEL_REDUCE_SLOPE 0.0
+
+enum Operation {
+    ADD_NODE,
+    DELETE_NODE,
+    REVERSE,
+    SORT,
+    ROTATE,
+    ROTATE_RIGHT,
+    REMOVE_DUPLICATES,
+    SWAP_PAIRS,
+    REVERSE_IN_GROUPS,
+    MERGE_SORTED_HALVES,
+    READ_WRITE,
+    PARALLEL_TRANSFORM,
+    OPERATION_COUNT
+};
+
+// Helper function to check that the list holds exactly the reference values
+void checkMatches(LinkedList& list, const std::list<int>& reference) {
+    Node* current = list.getHead();
+    for (int value : reference) {
+        ASSERT(current != nullptr);
+        ASSERT_EQ(current->data, value);
+        current = current->next;
+    }
+    ASSERT(current == nullptr);
+    ASSERT_EQ(list.length(), static_cast<int>(reference.size()));
+    ASSERT_FALSE(list.hasLoop());
+
+    // The cached tail must be the real last node
+    if (reference.empty()) {
+        ASSERT(list.getTail() == nullptr);
+    } else {
+        ASSERT(list.getTail() != nullptr && list.getTail()->next == nullptr);
+        ASSERT_EQ(list.getTail()->data, reference.back());
+    }
+}
+
+// Helper function to check the read-only queries against the reference values
+void checkQueries(LinkedList& list, const std::list<int>& reference, int value) {
+    std::vector<int> values(reference.begin(), reference.end());
+    std::vector<int> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    int size = static_cast<int>(values.size());
+
+    std::pair<std::vector<int>::iterator, std::vector<int>::iterator> range =
+        std::equal_range(sorted.begin(), sorted.end(), value);
+    ASSERT_EQ(list.binarySearch(value), range.first != range.second);
+    ASSERT_EQ(list.countOf(value), static_cast<int>(range.second - range.first));
+
+    long long total = 0;
+    for (int v : values) {
+        total += v;
+    }
+    ASSERT_EQ(list.sum(), total);
+    ASSERT_EQ(list.parallelReduce(0LL,
+        [](long long partial, int v) { return partial + v; },
+        [](long long left, long long right) { return left + right; }), total);
+
+    // Batched queries must agree with the reference, in query order
+    std::vector<int> keys;
+    std::vector<int> indices;
+    for (int i = 0; i < MAX_FUZZ_QUERIES; ++i) {
+        keys.push_back(DeepState_IntInRange(0, MAX_FUZZ_VALUE));
+        indices.push_back(DeepState_IntInRange(-1, size));
+    }
+    std::vector<bool> contained = list.containsBatch(keys);
+    std::vector<Node*> nodes = list.nthBatch(indices);
+    for (int i = 0; i < MAX_FUZZ_QUERIES; ++i) {
+        ASSERT_EQ(contained[i], std::binary_search(sorted.begin(), sorted.end(), keys[i]));
+        if (indices[i] < 0 || indices[i] >= size) {
+            ASSERT(nodes[i] == nullptr);
+        } else {
+            ASSERT(nodes[i] != nullptr);
+            ASSERT_EQ(nodes[i]->data, values[indices[i]]);
+        }
+    }
+
+    if (size == 0) {
+        ASSERT_EQ(list.kthSmallest(1), -1);
+        ASSERT_EQ(list.minValue(), -1);
+        return;
+    }
+
+    // Selection and aggregates against the sorted copy
+    int k = DeepState_IntInRange(1, size);
+    ASSERT_EQ(list.kthSmallest(k), sorted[k - 1]);
+    ASSERT_EQ(list.kthLargest(k), sorted[size - k]);
+    ASSERT_EQ(list.minValue(), sorted.front());
+    ASSERT_EQ(list.maxValue(), sorted.back());
+    if (size > 1) {
+        ASSERT_EQ(list.secondMinValue(), sorted[1]);
+        ASSERT_EQ(list.secondMaxValue(), sorted[size - 2]);
+    }
+
+    std::vector<int> top = list.topK(MAX_FUZZ_QUERIES);
+    ASSERT_EQ(top.size(), static_cast<size_t>(std::min(size, MAX_FUZZ_QUERIES)));
+    for (size_t i = 0; i < top.size(); ++i) {
+        ASSERT_EQ(top[i], sorted[size - 1 - i]);
+    }
+}
+
+TEST(LinkedListFuzz, DifferentialOperations) {
+    // Initialize the linked list and a std::list reference model
+    LinkedList list;
+    std::list<int> reference;
+
+    // Pick the length on a log scale so that tiny and very large lists are
+    // both common, and draw the bulk values from a seeded generator because
+    // a million values would not fit in the fuzzer's input
+    int length = std::min(DeepState_IntInRange(0, 1 << DeepState_IntInRange(0, 20)), MAX_FUZZ_LENGTH);
+    int maxValue = DeepState_IntInRange(0, MAX_FUZZ_VALUE);
+    std::mt19937 generator(DeepState_UInt());
+    std::uniform_int_distribution<int> distribution(0, maxValue);
+    for (int i = 0; i < length; ++i) {
+        int value = distribution(generator);
+        list.addNode(value);
+        reference.push_back(value);
+    }
+
+    // Optionally turn on the incremental aggregates and the hash index
+    if (DeepState_Bool()) {
+        list.enableAggregates();
+    }
+    if (DeepState_Bool()) {
+        list.enableIndex();
+    }
+    checkMatches(list, reference);
+
+    // Apply a random sequence of operations to both lists, keeping sequences
+    // on large lists short since every step is checked in full
+    int maxOperations = length > LARGE_FUZZ_LENGTH ? MAX_LARGE_FUZZ_OPERATIONS : MAX_FUZZ_OPERATIONS;
+    int operations = DeepState_IntInRange(1, maxOperations);
+    for (int step = 0; step < operations; ++step) {
+        int value = DeepState_IntInRange(0, maxValue);
+        int size = static_cast<int>(reference.size());
+
+        switch (DeepState_IntInRange(0, OPERATION_COUNT - 1)) {
+        case ADD_NODE:
+            list.addNode(value);
+            reference.push_back(value);
+            break;
+
+        case DELETE_NODE: {
+            list.deleteNode(value, list.getHead());
+            std::list<int>::iterator found = std::find(reference.begin(), reference.end(), value);
+            if (found != reference.end()) {
+                reference.erase(found);
+            }
+            break;
+        }
+
+        case REVERSE:
+            list.reverseLinkedList();
+            reference.reverse();
+            break;
+
+        case SORT:
+            list.sortLinkedList();
+            reference.sort();
+            break;
+
+        case ROTATE:
+        case ROTATE_RIGHT: {
+            int k = DeepState_IntInRange(0, 2 * size + 1);
+            Node* head = list.getHead();
+            if (DeepState_Bool()) {
+                list.rotate(k);
+            } else {
+                ASSERT(list.rotateRight(head, k) == list.getHead());
+            }
+            if (size > 0 && k % size != 0) {
+                reference.splice(reference.begin(), reference, std::prev(reference.end(), k % size), reference.end());
+            }
+            break;
+        }
+
+        case REMOVE_DUPLICATES: {
+            list.removeDuplicates();
+            std::unordered_set<int> seen;
+            for (std::list<int>::iterator it = reference.begin(); it != reference.end();) {
+                it = seen.insert(*it).second ? std::next(it) : reference.erase(it);
+            }
+            break;
+        }
+
+        case SWAP_PAIRS:
+        case REVERSE_IN_GROUPS: {
+            int k = 2;
+            if (DeepState_Bool()) {
+                k = DeepState_IntInRange(2, 64);
+                list.reverseInGroups(k);
+            } else {
+                ASSERT(list.swapPairs(list.getHead()) == list.getHead());
+            }
+            std::vector<int> values(reference.begin(), reference.end());
+            for (size_t start = 0; start + k <= values.size(); start += k) {
+                std::reverse(values.begin() + start, values.begin() + start + k);
+            }
+            reference.assign(values.begin(), values.end());
+            break;
+        }
+
+        case MERGE_SORTED_HALVES: {
+            // Sort, split at the middle node and merge the halves back together
+            list.sortLinkedList();
+            reference.sort();
+            Node* middle = list.findMiddleNode(list.getHead());
+            if (middle != nullptr) {
+                Node* secondHalf = middle->next;
+                middle->next = nullptr;
+                ASSERT(list.mergeSortedLists(list.getHead(), secondHalf) == list.getHead());
+            }
+            break;
+        }
+
+        case READ_WRITE: {
+            // Round-trip through the text format into a fresh list
+            std::stringstream stream;
+            ASSERT(list.writeTo(stream));
+            LinkedList copy;
+            ASSERT(copy.readFrom(stream));
+            checkMatches(copy, reference);
+            break;
+        }
+
+        case PARALLEL_TRANSFORM:
+            list.parallelTransform([maxValue](int v) { return maxValue - v; });
+            for (int& v : reference) {
+                v = maxValue - v;
+            }
+            break;
+        }
+
+        checkMatches(list, reference);
+        checkQueries(list, reference, value);
+    }
+}
+
+// Helper function to fill a list with random values in [0, maxValue]
+void fillList(LinkedList& list, int length, int maxValue, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution(0, maxValue);
+    for (int i = 0; i < length; ++i) {
+        list.addNode(distribution(generator));
+    }
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs operation(length), which returns the seconds spent in its timed part,
+// until enough time has been measured to be above timer noise, and returns
+// the best time per call over a few repeats.
+template <typename Operation>
+double timePerCall(int length, Operation operation) {
+    double best = 0;
+    for (int repeat = 0; repeat < COMPLEXITY_REPEATS; ++repeat) {
+        double total = 0;
+        int calls = 0;
+        while (total < COMPLEXITY_MIN_SECONDS) {
+            total += operation(length);
+            calls++;
+        }
+        if (repeat == 0 || total / calls < best) {
+            best = total / calls;
+        }
+    }
+    return best;
+}
+
+// Expected cost of an operation on a list of N nodes
+enum Growth {
+    LINEAR,
+    LINEARITHMIC
+};
+
+// Memory access pattern of an operation, which picks the walk it is measured
+// against: nodes in allocation order, or nodes relinked by sorting random
+// values so that every step lands somewhere unrelated in memory
+enum Access {
+    SEQUENTIAL,
+    SCATTERED
+};
+
+// Time for one plain walk over a freshly built list, used to factor cache
+// effects out of the timings as lists outgrow each level of the cache
+double walkTime(int length, Access access) {
+    LinkedList list;
+    fillList(list, length, length, length);
+    if (access == SCATTERED) {
+        list.sortLinkedList();
+    }
+    return timePerCall(length, [&list](int) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        list.length();
+        return secondsSince(start);
+    });
+}
+
+// Times the operation at doubling lengths, relative to a walk of the same
+// length and access pattern, and divided by log2(length) for linearithmic
+// operations. Returns the least-squares slope of that cost against the
+// length on a log-log scale, over every doubling.
+template <typename Operation>
+double growthSlope(Growth growth, Access access, Operation operation) {
+    std::vector<double> x;
+    std::vector<double> y;
+    int length = COMPLEXITY_MIN_LENGTH;
+    for (int doubling = 0; doubling <= COMPLEXITY_DOUBLINGS; ++doubling, length *= 2) {
+        double cost = timePerCall(length, operation) / walkTime(length, access);
+        if (growth == LINEARITHMIC) {
+            cost /= std::log2(length);
+        }
+        LOG(TRACE) << "length " << length << ": " << cost << " walks";
+        x.push_back(std::log2(length));
+        y.push_back(std::log2(cost));
+    }
+
+    double meanX = 0;
+    double meanY = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        meanX += x[i] / x.size();
+        meanY += y[i] / y.size();
+    }
+    double covariance = 0;
+    double variance = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        covariance += (x[i] - meanX) * (y[i] - meanY);
+        variance += (x[i] - meanX) * (x[i] - meanX);
+    }
+    double slope = covariance / variance;
+    LOG(TRACE) << "slope " << slope;
+    return slope;
+}
+
+// Fails if the operation's slope exceeds the one recorded for it on a healthy
+// build by more than COMPLEXITY_TOLERANCE. Cache effects give every operation
+// its own baseline slope; an extra factor of sqrt(length) adds 0.2 to 0.4.
+template <typename Operation>
+void checkGrowth(Growth growth, Access access, double recordedSlope, Operation operation) {
+    double slope = growthSlope(growth, access, operation);
+    ASSERT_LE(slope, recordedSlope + COMPLEXITY_TOLERANCE);
+}
+
+TEST(LinkedListComplexity, AddNode) {
+    // Appending should cost O(1) per node
+    checkGrowth(LINEAR, SEQUENTIAL, ADD_NODE_SLOPE, [](int length) {
+        LinkedList list;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < length; ++i) {
+            list.addNode(i);
+        }
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, ReadWrite) {
+    // Streaming out and back in should be linear
+    checkGrowth(LINEAR, SEQUENTIAL, READ_WRITE_SLOPE, [](int length) {
+        LinkedList list;
+        fillList(list, length, length, length);
+        std::stringstream stream;
+        LinkedList copy;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        list.writeTo(stream);
+        copy.readFrom(stream);
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, SortLinkedList) {
+    // Merge sort should be O(N log N)
+    checkGrowth(LINEARITHMIC, SEQUENTIAL, SORT_SLOPE, [](int length) {
+        LinkedList list;
+        fillList(list, length, length, length);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        list.sortLinkedList();
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, Reordering) {
+    // Reverse, rotate, block reversal and duplicate removal are single passes
+    checkGrowth(LINEAR, SEQUENTIAL, REORDERING_SLOPE, [](int length) {
+        LinkedList list;
+        fillList(list, length, length, length);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        list.reverseLinkedList();
+        list.rotate(length / 3);
+        list.reverseInGroups(8);
+        list.swapPairs(list.getHead());
+        list.removeDuplicates();
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, IndexedDelete) {
+    // With the index, deleting every value should cost O(1) per delete
+    checkGrowth(LINEAR, SCATTERED, INDEXED_DELETE_SLOPE, [](int length) {
+        LinkedList list;
+        fillList(list, length, length, length);
+        list.enableIndex();
+        list.binarySearch(0);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int value = 0; value <= length; ++value) {
+            list.deleteNode(value, list.getHead());
+        }
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, IndexedDeleteRepeatedValues) {
+    // A handful of values repeated many times must not slow the index down
+    checkGrowth(LINEAR, SCATTERED, REPEATED_VALUES_SLOPE, [](int length) {
+        LinkedList list;
+        fillList(list, length, LOW_CARDINALITY_VALUES - 1, length);
+        list.enableIndex();
+        list.binarySearch(0);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < length; ++i) {
+            list.deleteNode(i % LOW_CARDINALITY_VALUES, list.getHead());
+        }
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, BatchedQueries) {
+    // One traversal plus sorting the queries: O(N + Q log Q) with Q = N
+    checkGrowth(LINEARITHMIC, SEQUENTIAL, BATCHED_QUERIES_SLOPE, [](int length) {
+        LinkedList list;
+        fillList(list, length, length, length);
+        std::vector<int> queries;
+        std::mt19937 generator(length);
+        for (int i = 0; i < length; ++i) {
+            queries.push_back(static_cast<int>(generator() % (2 * length)));
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        list.containsBatch(queries);
+        list.nthBatch(queries);
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, Selection) {
+    // Selection without sorting should be linear for small and large k
+    checkGrowth(LINEAR, SEQUENTIAL, SELECTION_SLOPE, [](int length) {
+        LinkedList list;
+        fillList(list, length, length, length);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        list.kthLargest(2);
+        list.kthSmallest(length / 2);
+        list.topK(32);
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, TrackedAggregates) {
+    // Tracked updates cost O(log N) and queries O(1)
+    checkGrowth(LINEARITHMIC, SCATTERED, TRACKED_AGGREGATES_SLOPE, [](int length) {
+        LinkedList list;
+        list.enableAggregates();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        fillList(list, length, length, length);
+        for (int i = 0; i < length; ++i) {
+            list.minValue();
+            list.secondMaxValue();
+            list.sum();
+        }
+        list.removeDuplicates();
+        return secondsSince(start);
+    });
+}
+
+TEST(LinkedListComplexity, ParallelReduce) {
+    // Reductions over cached segments should be linear
+    checkGrowth(LINEAR, SEQUENTIAL, PARALLEL_REDUCE_SLOPE, [](int length) {
+        LinkedList list;
+        fillList(list, length, length, length);
+        list.parallelReduce(0LL,
+            [](long long partial, int v) { return partial + v; },
+            [](long long left, long long right) { return left + right; });
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        list.parallelTransform([](int v) { return v + 1; });
+        list.parallelReduce(0LL,
+            [](long long partial, int v) { return partial + v; },
+            [](long long left, long long right) { return left + right; });
+        return secondsSince(start);
+    });
+}
+
+// Extra full walks that turn an O(N) or O(N log N) operation into O(N^1.5),
+// about 45 walks at the largest length
+void injectRegression(LinkedList& list, int length) {
+    int walks = static_cast<int>(std::sqrt(static_cast<double>(length))) / 8;
+    for (int i = 0; i < walks; ++i) {
+        list.length();
+    }
+}
+
+TEST(LinkedListComplexity, DetectsRegressions) {
+    // The checks above must reject an extra factor of sqrt(N) on both paths
+    double linear = growthSlope(LINEAR, SEQUENTIAL, [](int length) {
+        LinkedList list;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < length; ++i) {
+            list.addNode(i);
+        }
+        injectRegression(list, length);
+        return secondsSince(start);
+    });
+    ASSERT_GT(linear, ADD_NODE_SLOPE + COMPLEXITY_TOLERANCE);
+
+    double linearithmic = growthSlope(LINEARITHMIC, SEQUENTIAL, [](int length) {
+        LinkedList list;
+        fillList(list, length, length, length);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        list.sortLinkedList();
+        injectRegression(list, length);
+        return secondsSince(start);
+    });
+    ASSERT_GT(linearithmic, SORT_SLOPE + COMPLEXITY_TOLERANCE);
+}
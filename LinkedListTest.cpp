@@ -1,10 +1,18 @@
 #include <deepstate/DeepState.hpp>
 #include "LinkedList.h"
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
 
 using namespace deepstate;
 
 #define MAX_VALUE 100
 #define MAX_LENGTH 10
+#define DUPLICATE_LENGTH 2048
+#define DUPLICATE_VALUES 3
+#define PARALLEL_LENGTH (1 << 15)
 
 TEST(LinkedList, GetHead) {
     // Initialize the linked list
@@ -421,4 +429,464 @@ TEST(LinkedList, GetSecondMaxAndMin) {
     // Check if linked list is not updated
     ASSERT(list.getHead()->data==1);
     ASSERT(list.getTail()->data==5);
-}
\ No newline at end of file
+}
+
+TEST(LinkedList, ReadWriteRoundTrip) {
+    // Initialize the linked list
+    LinkedList list;
+
+    // Generate random values, including negative ones, and add nodes to the list
+    int values[MAX_LENGTH];
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        values[i] = DeepState_Int();
+        list.addNode(values[i]);
+    }
+
+    // Write the list out and parse it back into a second list
+    std::stringstream stream;
+    ASSERT(list.writeTo(stream));
+    LinkedList copy;
+    ASSERT(copy.readFrom(stream));
+    ASSERT(stream.eof() && !stream.fail());
+
+    // Check that both lists hold the same values in the same order
+    ASSERT_EQ(copy.length(), MAX_LENGTH);
+    Node* current = copy.getHead();
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        ASSERT_EQ(current->data, values[i]);
+        current = current->next;
+    }
+
+    // Reading appends to the existing list and accepts mixed separators
+    std::stringstream more("7\n-8\t 9");
+    ASSERT(copy.readFrom(more));
+    ASSERT_EQ(copy.length(), MAX_LENGTH + 3);
+    ASSERT_EQ(copy.getTail()->data, 9);
+
+    // Malformed input is rejected
+    std::stringstream bad("1 2x 3");
+    ASSERT_FALSE(copy.readFrom(bad));
+    ASSERT(bad.fail());
+
+    // A stream that has already failed is left alone
+    ASSERT_FALSE(copy.readFrom(bad));
+    ASSERT_EQ(copy.length(), MAX_LENGTH + 4);
+}
+
+TEST(LinkedList, ContainsBatch) {
+    // Initialize the linked list
+    LinkedList list;
+
+    // Generate random values and add nodes to the list
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        list.addNode(DeepState_IntInRange(0, MAX_VALUE));
+    }
+
+    // Build a batch of random keys, including repeats
+    std::vector<int> keys;
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        keys.push_back(DeepState_IntInRange(0, MAX_VALUE));
+    }
+    keys.push_back(keys[0]);
+
+    // Each batched answer should match the single-key search, in query order
+    std::vector<bool> found = list.containsBatch(keys);
+    ASSERT_EQ(found.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(found[i], list.binarySearch(keys[i]));
+    }
+}
+
+TEST(LinkedList, NthBatch) {
+    // Initialize the linked list
+    LinkedList list;
+
+    // Generate random values and add nodes to the list
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        list.addNode(DeepState_IntInRange(0, MAX_VALUE));
+    }
+
+    // Build a batch of random indices, including out-of-bounds ones
+    std::vector<int> indices;
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        indices.push_back(DeepState_IntInRange(-1, MAX_LENGTH + 1));
+    }
+
+    // Each batched answer should match the single-index lookup, in query order
+    std::vector<Node*> nodes = list.nthBatch(indices);
+    ASSERT_EQ(nodes.size(), indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        ASSERT_EQ(nodes[i], list.getNthNode(indices[i]));
+    }
+}
+
+TEST(LinkedList, KthLargestAndSmallest) {
+    // Initialize the linked list
+    LinkedList list;
+
+    // Generate random values, add nodes to the list, and keep a copy
+    std::vector<int> values;
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        values.push_back(DeepState_IntInRange(0, MAX_VALUE));
+        list.addNode(values.back());
+    }
+    Node* originalHead = list.getHead();
+
+    // Compare against a sorted copy
+    std::sort(values.begin(), values.end());
+    int k = DeepState_IntInRange(1, MAX_LENGTH);
+    ASSERT_EQ(list.kthSmallest(k), values[k - 1]);
+    ASSERT_EQ(list.kthLargest(k), values[MAX_LENGTH - k]);
+
+    // Out-of-range k returns -1
+    ASSERT_EQ(list.kthLargest(0), -1);
+    ASSERT_EQ(list.kthSmallest(MAX_LENGTH + 1), -1);
+
+    // topK returns the k largest values in descending order
+    std::vector<int> top = list.topK(k);
+    ASSERT_EQ(top.size(), static_cast<size_t>(k));
+    for (int i = 0; i < k; ++i) {
+        ASSERT_EQ(top[i], values[MAX_LENGTH - 1 - i]);
+    }
+
+    // Check if linked list is not updated
+    ASSERT(list.getHead() == originalHead);
+    ASSERT_EQ(list.length(), MAX_LENGTH);
+}
+
+// Helper function to check the tracked aggregates against a fresh traversal
+void checkAggregates(LinkedList& tracked, LinkedList& plain) {
+    ASSERT_EQ(tracked.minValue(), plain.minValue());
+    ASSERT_EQ(tracked.maxValue(), plain.maxValue());
+    ASSERT_EQ(tracked.secondMinValue(), plain.secondMinValue());
+    ASSERT_EQ(tracked.secondMaxValue(), plain.secondMaxValue());
+    ASSERT_EQ(tracked.sum(), plain.sum());
+}
+
+TEST(LinkedList, TrackedAggregates) {
+    // Initialize one list that tracks aggregates and one that does not
+    LinkedList tracked;
+    LinkedList plain;
+    tracked.addNode(MAX_VALUE);
+    plain.addNode(MAX_VALUE);
+    tracked.enableAggregates();
+
+    // Generate random values and add nodes to both lists
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        int value = DeepState_IntInRange(0, MAX_VALUE);
+        tracked.addNode(value);
+        plain.addNode(value);
+        checkAggregates(tracked, plain);
+    }
+    ASSERT_EQ(tracked.countOf(MAX_VALUE), plain.countOf(MAX_VALUE));
+
+    // Delete the current extremes, including the head, and check again
+    for (int i = 0; i < 3; ++i) {
+        int value = (i % 2 == 0) ? plain.maxValue() : plain.minValue();
+        tracked.deleteNode(value, tracked.getHead());
+        plain.deleteNode(value, plain.getHead());
+        ASSERT_EQ(tracked.length(), plain.length());
+        checkAggregates(tracked, plain);
+    }
+
+    // Removing duplicates and clearing the list keep the aggregates in sync
+    tracked.removeDuplicates();
+    plain.removeDuplicates();
+    checkAggregates(tracked, plain);
+    tracked.deleteLinkedList();
+    plain.deleteLinkedList();
+    checkAggregates(tracked, plain);
+    ASSERT_EQ(tracked.minValue(), -1);
+    ASSERT_EQ(tracked.sum(), 0);
+}
+
+TEST(LinkedList, ReverseInGroups) {
+    // Initialize the linked list
+    LinkedList list;
+
+    // Add nodes 0..MAX_LENGTH-1 so positions are easy to check
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        list.addNode(i);
+    }
+
+    // Reverse in groups of a random size
+    int k = DeepState_IntInRange(2, MAX_LENGTH + 1);
+    list.reverseInGroups(k);
+
+    // Full groups are reversed and the trailing partial group keeps its order
+    int fullGroups = MAX_LENGTH / k;
+    Node* current = list.getHead();
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        int group = i / k;
+        int expected = group < fullGroups ? group * k + (k - 1 - i % k) : i;
+        ASSERT(current != nullptr);
+        ASSERT_EQ(current->data, expected);
+        current = current->next;
+    }
+    ASSERT(current == nullptr);
+
+    // Swapping pairs on the list head updates the list itself
+    LinkedList pairs;
+    pairs.addNode(1);
+    pairs.addNode(2);
+    pairs.addNode(3);
+    Node* swappedHead = pairs.swapPairs(pairs.getHead());
+    ASSERT(swappedHead == pairs.getHead());
+    ASSERT_EQ(pairs.getHead()->data, 2);
+    ASSERT_EQ(pairs.getTail()->data, 3);
+    ASSERT_EQ(pairs.length(), 3);
+}
+
+// Helper function to check whether a node lives inside the list object
+bool isStoredInline(LinkedList& list, Node* node) {
+    const char* begin = reinterpret_cast<const char*>(&list);
+    const char* address = reinterpret_cast<const char*>(node);
+    std::less<const char*> before;
+    return !before(address, begin) && before(address, begin + sizeof(LinkedList));
+}
+
+TEST(LinkedList, InlineStorage) {
+    // Initialize the linked list
+    LinkedList list;
+
+    // Fill the inline slots and spill a few more nodes onto the heap
+    int count = LINKEDLIST_INLINE_NODES + MAX_LENGTH;
+    for (int i = 0; i < count; ++i) {
+        list.addNode(i);
+    }
+    ASSERT(isStoredInline(list, list.getHead()));
+    ASSERT_FALSE(isStoredInline(list, list.getTail()));
+
+    // Delete a random inline node and a random heap node
+    int inlineValue = DeepState_IntInRange(0, LINKEDLIST_INLINE_NODES - 1);
+    int heapValue = DeepState_IntInRange(LINKEDLIST_INLINE_NODES, count - 1);
+    list.deleteNode(inlineValue, list.getHead());
+    list.deleteNode(heapValue, list.getHead());
+    ASSERT_EQ(list.length(), count - 2);
+
+    // The freed inline slot is reused by the next node
+    list.addNode(-1);
+    ASSERT(isStoredInline(list, list.getTail()));
+
+    // Operations behave the same across both representations
+    list.sortLinkedList();
+    Node* current = list.getHead();
+    while (current && current->next != nullptr) {
+        ASSERT(current->data <= current->next->data);
+        current = current->next;
+    }
+    ASSERT_EQ(list.getHead()->data, -1);
+    ASSERT_FALSE(list.binarySearch(inlineValue));
+    ASSERT_FALSE(list.binarySearch(heapValue));
+
+    // Clearing the list makes every inline slot available again
+    list.deleteLinkedList();
+    list.addNode(1);
+    ASSERT(isStoredInline(list, list.getHead()));
+}
+
+TEST(LinkedList, IndexedDeleteAndLookup) {
+    // Initialize one indexed list and one plain list
+    LinkedList indexed;
+    LinkedList plain;
+    indexed.enableIndex();
+
+    // Generate random values, with plenty of repeats, and add them to both lists
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        int value = DeepState_IntInRange(0, MAX_LENGTH / 2);
+        indexed.addNode(value);
+        plain.addNode(value);
+    }
+
+    // Interleave deletes, lookups and bulk operations that force a rebuild
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        int value = DeepState_IntInRange(0, MAX_LENGTH / 2);
+        ASSERT_EQ(indexed.binarySearch(value), plain.binarySearch(value));
+        ASSERT_EQ(indexed.getNthNodeIndex(indexed.findNode(value)), plain.getNthNodeIndex(plain.findNode(value)));
+
+        indexed.deleteNode(value, indexed.getHead());
+        plain.deleteNode(value, plain.getHead());
+
+        if (i == MAX_LENGTH / 2) {
+            indexed.rotate(3);
+            plain.rotate(3);
+            indexed.reverseLinkedList();
+            plain.reverseLinkedList();
+        }
+        indexed.addNode(i);
+        plain.addNode(i);
+    }
+
+    // Both lists should still hold the same values in the same order
+    ASSERT_EQ(indexed.length(), plain.length());
+    Node* left = indexed.getHead();
+    Node* right = plain.getHead();
+    while (right != nullptr) {
+        ASSERT_EQ(left->data, right->data);
+        left = left->next;
+        right = right->next;
+    }
+    ASSERT(left == nullptr);
+}
+
+TEST(LinkedList, IndexedDuplicates) {
+    // Initialize one indexed list and one plain list
+    LinkedList indexed;
+    LinkedList plain;
+    indexed.enableIndex();
+
+    // Fill both lists with a long run of a few repeated values
+    for (int i = 0; i < DUPLICATE_LENGTH; ++i) {
+        int value = DeepState_IntInRange(0, DUPLICATE_VALUES - 1);
+        indexed.addNode(value);
+        plain.addNode(value);
+    }
+
+    // Deleting always removes the first copy, even with thousands of equal values
+    for (int i = 0; i < DUPLICATE_LENGTH; ++i) {
+        int value = DeepState_IntInRange(0, DUPLICATE_VALUES);
+        ASSERT_EQ(indexed.getNthNodeIndex(indexed.findNode(value)), plain.getNthNodeIndex(plain.findNode(value)));
+
+        indexed.deleteNode(value, indexed.getHead());
+        plain.deleteNode(value, plain.getHead());
+
+        if (i == DUPLICATE_LENGTH / 2) {
+            indexed.reverseLinkedList();
+            plain.reverseLinkedList();
+        }
+        if (DeepState_Bool()) {
+            value = DeepState_IntInRange(0, DUPLICATE_VALUES - 1);
+            indexed.addNode(value);
+            plain.addNode(value);
+        }
+    }
+
+    // Both lists should still hold the same values in the same order
+    ASSERT_EQ(indexed.length(), plain.length());
+    Node* left = indexed.getHead();
+    Node* right = plain.getHead();
+    while (right != nullptr) {
+        ASSERT_EQ(left->data, right->data);
+        left = left->next;
+        right = right->next;
+    }
+    ASSERT(left == nullptr);
+}
+
+TEST(LinkedList, ParallelOperations) {
+    // Initialize the linked list
+    LinkedList list;
+
+    // Generate random values, add nodes to the list, and keep a running sum
+    long long expectedSum = 0;
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        int value = DeepState_IntInRange(0, MAX_VALUE);
+        list.addNode(value);
+        expectedSum += value;
+    }
+    list.enableAggregates();
+
+    // Reduce the list in parallel
+    long long total = list.parallelReduce(0LL,
+        [](long long partial, int value) { return partial + value; },
+        [](long long left, long long right) { return left + right; });
+    ASSERT_EQ(total, expectedSum);
+
+    // Count values with a parallel for-each
+    std::atomic<int> visited(0);
+    list.parallelForEach([&visited](int) { visited++; });
+    ASSERT_EQ(visited.load(), MAX_LENGTH);
+
+    // Transform in place and check the values and the tracked aggregates
+    list.parallelTransform([](int value) { return value * 2; });
+    ASSERT_EQ(list.sum(), expectedSum * 2);
+    ASSERT_EQ(list.parallelReduce(0LL,
+        [](long long partial, int value) { return partial + value; },
+        [](long long left, long long right) { return left + right; }), expectedSum * 2);
+}
+
+TEST(LinkedList, ParallelNestingAndExceptions) {
+    // Initialize a list long enough to be split into segments
+    LinkedList list;
+    long long expectedSum = 0;
+    for (int i = 0; i < PARALLEL_LENGTH; ++i) {
+        int value = DeepState_IntInRange(0, MAX_VALUE);
+        list.addNode(value);
+        expectedSum += value;
+    }
+    list.enableAggregates();
+
+    // Append a second run after the split points have been cached
+    list.parallelForEach([](int) {});
+    for (int i = 0; i < PARALLEL_LENGTH; ++i) {
+        int value = DeepState_IntInRange(0, MAX_VALUE);
+        list.addNode(value);
+        expectedSum += value;
+    }
+
+    // A callback may start another parallel operation on the same list
+    std::atomic<long long> nestedTotal(0);
+    std::atomic<int> calls(0);
+    list.parallelForEach([&](int) {
+        if (calls++ == 0) {
+            nestedTotal += list.parallelReduce(0LL,
+                [](long long partial, int v) { return partial + v; },
+                [](long long left, long long right) { return left + right; });
+        }
+    });
+    ASSERT_EQ(nestedTotal.load(), expectedSum);
+    ASSERT_EQ(calls.load(), 2 * PARALLEL_LENGTH);
+
+    // An exception thrown by a callback reaches the caller and leaves the pool usable
+    int thrower = DeepState_IntInRange(0, MAX_VALUE);
+    bool caught = false;
+    try {
+        list.parallelForEach([thrower](int value) {
+            if (value == thrower)
+                throw std::runtime_error("callback failed");
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    ASSERT_EQ(caught, list.countOf(thrower) > 0);
+
+    // A transform that throws part way still keeps the aggregates consistent
+    try {
+        list.parallelTransform([thrower](int value) {
+            if (value == thrower)
+                throw std::runtime_error("callback failed");
+            return value + 1;
+        });
+    } catch (const std::runtime_error&) {
+    }
+    long long walked = 0;
+    for (Node* current = list.getHead(); current != nullptr; current = current->next)
+        walked += current->data;
+    ASSERT_EQ(list.sum(), walked);
+    ASSERT_EQ(list.parallelReduce(0LL,
+        [](long long partial, int v) { return partial + v; },
+        [](long long left, long long right) { return left + right; }), walked);
+}
+
+TEST(LinkedList, HasLoop) {
+    // Initialize the linked list
+    LinkedList list;
+
+    // Generate random values and add nodes to the list
+    for (int i = 0; i < MAX_LENGTH; ++i) {
+        list.addNode(DeepState_IntInRange(0, MAX_VALUE));
+    }
+
+    // A plain list has no loop
+    ASSERT_FALSE(list.hasLoop());
+
+    // Link the tail back to a random node to create a loop
+    Node* target = list.getNthNode(DeepState_IntInRange(0, MAX_LENGTH - 1));
+    Node* tail = list.getTail();
+    tail->next = target;
+    ASSERT(list.hasLoop());
+
+    // Break the loop again so the list can be freed
+    tail->next = nullptr;
+    ASSERT_FALSE(list.hasLoop());
+}
@@ -83,6 +83,11 @@ int main() {
     list.swapPairs(list.getHead());
     list.printLinkedList();
 
+    // Test reverseInGroups function
+    std::cout << "List after reversing in groups of 3: ";
+    list.reverseInGroups(3);
+    list.printLinkedList();
+
     // Test getSecondMax function
     list.sortLinkedList();
     std::cout << "Second max: " << list.getSecondMax(list.getHead()) << std::endl;